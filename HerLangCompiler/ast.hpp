@@ -4,8 +4,26 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
+
+// Static types assigned by infer_types(); Unknown never survives the pass
+// (unconstrained variables and parameters default to Int).
+enum class ValueType {
+    Unknown,
+    Int,
+    Double,
+    String
+};
+
+// A literal or variable reference; kind is Identifier, Number or StringLiteral.
+struct Operand {
+    TokenType kind = TokenType::EOFToken;
+    std::string text;
+    Span span;
+};
 
 struct Statement {
+    Span span; // first token of the statement
     virtual ~Statement() = default;
 };
 
@@ -24,7 +42,38 @@ public:
 
 struct SetStatement : public Statement {
     std::string var;
-    SetStatement(const std::string& var) : var(var) {}
+    Operand value; // kind == EOFToken for a bare "set x"
+    SetStatement(const std::string& var, const Operand& value = Operand())
+        : var(var), value(value) {}
+};
+
+// add / minus / multiply / divide: var op= value
+struct ArithStatement : public Statement {
+    std::string op;
+    std::string var;
+    Operand value;
+    ArithStatement(const std::string& op, const std::string& var, const Operand& value)
+        : op(op), var(var), value(value) {}
+};
+
+struct Condition {
+    Operand lhs;
+    std::string op;
+    Operand rhs;
+};
+
+struct IfStatement : public Statement {
+    // One entry per "if"/"elif" branch, in source order.
+    std::vector<Condition> conds;
+    std::vector<std::vector<std::shared_ptr<Statement>>> bodies;
+    std::vector<std::shared_ptr<Statement>> else_body;
+};
+
+struct WhileStatement : public Statement {
+    Condition cond;
+    std::vector<std::shared_ptr<Statement>> body;
+    WhileStatement(const Condition& cond, const std::vector<std::shared_ptr<Statement>>& body)
+        : cond(cond), body(body) {}
 };
 
 struct FunctionCall : Statement {
@@ -40,6 +89,8 @@ struct FunctionDef : public Statement {
     std::string name;
     std::string param;
     std::vector<std::shared_ptr<Statement>> body;
+    ValueType param_type = ValueType::Unknown;
+    std::vector<std::pair<std::string, ValueType>> locals; // filled by infer_types()
     FunctionDef(const std::string& name, const std::string& param,
         const std::vector<std::shared_ptr<Statement>>& body)
         : name(name), param(param), body(body) {}
@@ -47,6 +98,7 @@ struct FunctionDef : public Statement {
 
 struct StartBlock : public Statement {
     std::vector<std::shared_ptr<Statement>> body;
+    std::vector<std::pair<std::string, ValueType>> locals; // filled by infer_types()
     StartBlock(const std::vector<std::shared_ptr<Statement>>& body)
         : body(body) {}
 };
@@ -0,0 +1,63 @@
+// diagnostics.cpp - Error collection shared by all compiler phases
+#include "diagnostics.hpp"
+#include <algorithm>
+
+Diagnostics::Diagnostics(size_t max_errors) : max_errors(max_errors) {
+    // The limit only bounds growth; a huge --max-errors must not allocate up front
+    items.reserve(max_errors != 0 ? std::min<size_t>(max_errors, 64) : 64);
+}
+
+static bool before(const Span& a, const Span& b) {
+    return a.line != b.line ? a.line < b.line : a.col < b.col;
+}
+
+void Diagnostics::error(const Span& span, const std::string& message) {
+    if (!full()) {
+        items.push_back({ span, message });
+        last_line = std::max(last_line, span.line);
+        return;
+    }
+
+    // Full: only rescan when an earlier error replaces the latest one
+    truncated = true;
+    auto last = std::max_element(items.begin(), items.end(), [](const Diagnostic& a, const Diagnostic& b) {
+        return before(a.span, b.span);
+    });
+    if (!before(span, last->span)) return;
+    *last = { span, message };
+
+    last_line = 0;
+    for (const auto& d : items) last_line = std::max(last_line, d.span.line);
+}
+
+void Diagnostics::print(std::ostream& out, const std::string& file, const std::vector<std::string>& lines) const {
+    // Phases run one after another; report in source order instead.
+    std::vector<Diagnostic> sorted = items;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Diagnostic& a, const Diagnostic& b) {
+        return before(a.span, b.span);
+    });
+
+    for (const auto& d : sorted) {
+        out << file << ":" << d.span.line;
+        if (d.span.col > 0) out << ":" << d.span.col;
+        out << ": error: " << d.message << "\n";
+
+        if (d.span.line < 1 || d.span.line > (int)lines.size()) continue;
+        const std::string& src = lines[d.span.line - 1];
+        out << "    " << src << "\n";
+        if (d.span.col > 0) {
+            std::string marker;
+            for (int i = 0; i < d.span.col - 1 && i < (int)src.size(); ++i) {
+                marker += src[i] == '\t' ? '\t' : ' ';
+            }
+            marker += '^';
+            if (d.span.length > 1) marker += std::string(d.span.length - 1, '~');
+            out << "    " << marker << "\n";
+        }
+    }
+
+    if (truncated) {
+        out << "Too many errors, stopping (limit " << max_errors << ", see --max-errors).\n";
+    }
+    out << sorted.size() << (sorted.size() == 1 ? " error" : " errors") << " generated.\n";
+}
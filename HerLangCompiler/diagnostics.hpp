@@ -0,0 +1,45 @@
+// diagnostics.hpp - Error collection shared by all compiler phases
+#pragma once
+#include "lexer.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct Diagnostic {
+    Span span;
+    std::string message;
+};
+
+// Errors are recorded instead of thrown so a single run reports all syntax
+// errors together; type errors follow once lexing and parsing succeeded.
+// A small buffer is reserved up front and grows up to max_errors. Once it is
+// full only errors located before the stored ones are kept (replacing the
+// last), so the report always shows the first max_errors errors in source
+// order whichever phase found them. max_errors == 0 means no limit.
+class Diagnostics {
+public:
+    explicit Diagnostics(size_t max_errors = 20);
+
+    void error(const Span& span, const std::string& message);
+
+    bool has_errors() const { return !items.empty(); }
+    bool full() const { return max_errors != 0 && items.size() >= max_errors; }
+    size_t count() const { return items.size(); }
+
+    // True when no error at or after line could still be reported; phases use
+    // this to stop early.
+    bool exhausted_at(int line) const { return full() && last_line < line; }
+
+    // Called by a phase that stops early, so the report says it is incomplete.
+    void mark_truncated() { truncated = true; }
+
+    // Prints "file:line:col: error: message" plus the offending source line.
+    void print(std::ostream& out, const std::string& file, const std::vector<std::string>& lines) const;
+
+private:
+    size_t max_errors;
+    std::vector<Diagnostic> items;
+    int last_line = 0;      // latest line among stored errors
+    bool truncated = false; // an error was dropped because the buffer was full
+};
@@ -22,7 +22,51 @@ static std::string escape_string(const std::string& s) {
     return out;
 }
 
-static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>& stmt, int indent_level = 1) {
+static const char* cpp_type(ValueType t) {
+    switch (t) {
+    case ValueType::Int:    return "int64_t";
+    case ValueType::Double: return "double";
+    case ValueType::String: return "std::string";
+    default:                return "auto";
+    }
+}
+
+static std::string gen_operand(const Operand& op) {
+    if (op.kind == TokenType::StringLiteral) return "\"" + escape_string(op.text) + "\"";
+    if (op.kind == TokenType::EOFToken) return "0";
+    return op.text;
+}
+
+static std::string gen_condition(const Condition& cond) {
+    // Two string literals would otherwise compare as pointers.
+    std::string lhs = gen_operand(cond.lhs);
+    if (cond.lhs.kind == TokenType::StringLiteral) lhs = "std::string(" + lhs + ")";
+    return lhs + " " + cond.op + " " + gen_operand(cond.rhs);
+}
+
+static std::string gen_signature(const FunctionDef* func) {
+    if (func->param.empty()) return "void " + func->name + "()";
+    return "void " + func->name + "(" + cpp_type(func->param_type) + " " + func->param + ")";
+}
+
+// All variables of a scope are declared up front with their inferred type,
+// so a "set" inside a nested block stays visible after it.
+static void gen_locals(std::ostringstream& out, const std::vector<std::pair<std::string, ValueType>>& locals, int indent_level) {
+    for (auto& [name, type] : locals) {
+        out << indent(indent_level) << cpp_type(type) << " " << name;
+        if (type != ValueType::String) out << " = 0";
+        out << ";\n";
+    }
+    if (!locals.empty()) out << "\n";
+}
+
+static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>& stmt, int indent_level = 1);
+
+static void gen_body(std::ostringstream& out, const std::vector<std::shared_ptr<Statement>>& body, int indent_level) {
+    for (auto& s : body) gen_stmt(out, s, indent_level);
+}
+
+static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>& stmt, int indent_level) {
     std::string ind = indent(indent_level);
 
     if (auto say = dynamic_cast<SayStatement*>(stmt.get())) {
@@ -38,22 +82,40 @@ static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>&
         }
 
         if (say->end == "\\n")
-            out << " << std::endl;\n";
+            out << " << '\\n';\n";
         else
             out << " << \"" << escape_string(say->end) << "\";\n";
     }
     else if (auto set = dynamic_cast<SetStatement*>(stmt.get())) {
-        out << ind << "auto " << set->var << " = 0;\n";
+        out << ind << set->var << " = " << gen_operand(set->value) << ";\n";
     }
-    else if (auto func = dynamic_cast<FunctionDef*>(stmt.get())) {
-        if (!func->param.empty()) {
-            out << "void " << func->name << "(auto " << func->param << ") {\n";
+    else if (auto arith = dynamic_cast<ArithStatement*>(stmt.get())) {
+        const char* op = arith->op == "add" ? "+=" :
+            arith->op == "minus" ? "-=" :
+            arith->op == "multiply" ? "*=" : "/=";
+        out << ind << arith->var << " " << op << " " << gen_operand(arith->value) << ";\n";
+    }
+    else if (auto branch = dynamic_cast<IfStatement*>(stmt.get())) {
+        for (size_t i = 0; i < branch->conds.size(); ++i) {
+            out << ind << (i == 0 ? "if (" : "else if (") << gen_condition(branch->conds[i]) << ") {\n";
+            gen_body(out, branch->bodies[i], indent_level + 1);
+            out << ind << "}\n";
         }
-        else {
-            out << "void " << func->name << "() {\n";
+        if (!branch->else_body.empty()) {
+            out << ind << "else {\n";
+            gen_body(out, branch->else_body, indent_level + 1);
+            out << ind << "}\n";
         }
-
-        for (auto& s : func->body) gen_stmt(out, s, indent_level + 1);
+    }
+    else if (auto loop = dynamic_cast<WhileStatement*>(stmt.get())) {
+        out << ind << "while (" << gen_condition(loop->cond) << ") {\n";
+        gen_body(out, loop->body, indent_level + 1);
+        out << ind << "}\n";
+    }
+    else if (auto func = dynamic_cast<FunctionDef*>(stmt.get())) {
+        out << gen_signature(func) << " {\n";
+        gen_locals(out, func->locals, indent_level + 1);
+        gen_body(out, func->body, indent_level + 1);
         out << "}\n";
     }
     else if (auto call = dynamic_cast<FunctionCall*>(stmt.get())) {
@@ -64,13 +126,14 @@ static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>&
         case TokenType::Keyword:        std::cerr << "Keyword    "; break;
         case TokenType::Identifier:     std::cerr << "Identifier "; break;
         case TokenType::StringLiteral:  std::cerr << "String     "; break;
+        case TokenType::Number:         std::cerr << "Number     "; break;
         case TokenType::Newline:        std::cerr << "Newline    "; break;
         case TokenType::EOFToken:       std::cerr << "EOF        "; break;
         case TokenType::Symbol:         std::cerr << "Symbol     "; break;
         }
         std::cerr << std::endl;
 #endif
-        if (!call->arg.empty()) {
+        if (call->arg_type != TokenType::EOFToken) {
             if (call->arg_type == TokenType::StringLiteral) {
                 out << "\"" << escape_string(call->arg) << "\"";
             }
@@ -82,7 +145,8 @@ static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>&
     }
     else if (auto main = dynamic_cast<StartBlock*>(stmt.get())) {
         out << "int main() {\n#ifdef _WIN32\nSetConsoleOutputCP(CP_UTF8);\n#endif\n\n";
-        for (auto& s : main->body) gen_stmt(out, s, indent_level + 1);
+        gen_locals(out, main->locals, indent_level + 1);
+        gen_body(out, main->body, indent_level + 1);
         out << indent(indent_level + 1) << "return 0;\n";
         out << "}\n";
     }
@@ -90,7 +154,17 @@ static void gen_stmt(std::ostringstream& out, const std::shared_ptr<Statement>&
 
 std::string generate_cpp(const AST& ast) {
     std::ostringstream out;
-    out << "#include <iostream>\n#include <string>\n\n#ifdef _WIN32\n#include <windows.h>\n#endif\n\n";
+    out << "#include <cstdint>\n#include <iostream>\n#include <string>\n\n#ifdef _WIN32\n#include <windows.h>\n#endif\n\n";
+
+    // Prototypes first so functions may call each other in any order
+    bool any_function = false;
+    for (auto& stmt : ast.statements) {
+        if (auto func = dynamic_cast<FunctionDef*>(stmt.get())) {
+            out << gen_signature(func) << ";\n";
+            any_function = true;
+        }
+    }
+    if (any_function) out << '\n';
 
     // к
     for (auto& stmt : ast.statements) {
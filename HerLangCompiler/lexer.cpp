@@ -1,18 +1,29 @@
 // lexer.cpp - MyLang lexer implementation
 #include "lexer.hpp"
 #include "utils.hpp"
-#include <regex>
+#include "diagnostics.hpp"
 #include <sstream>
 #include <cctype>
 
-std::vector<Token> lex(const std::vector<std::string>& lines) {
+std::vector<Token> lex(const std::vector<std::string>& lines, Diagnostics& diags) {
     std::vector<Token> tokens;
-    std::regex string_regex("\"(.*?)\"");
+    tokens.reserve(lines.size() * 4); // a few tokens per line is typical
 
     for (int i = 0; i < lines.size(); ++i) {
         std::string line = trim(lines[i]);
         if (line.empty() || line[0] == '#') continue;
 
+        // Columns are reported against the untrimmed source line
+        size_t indent = 0;
+        while (indent < lines[i].size() && std::isspace(static_cast<unsigned char>(lines[i][indent]))) ++indent;
+        auto span_at = [&](size_t start, size_t end) {
+            return Span{ i + 1, (int)(indent + start + 1), (int)(end - start) };
+        };
+        auto emit = [&](TokenType type, const std::string& value, size_t start, size_t end) {
+            Span sp = span_at(start, end);
+            tokens.push_back({ type, value, sp.line, sp.col, sp.length });
+        };
+
         size_t j = 0;
         while (j < line.size()) {
             if (std::isspace(line[j])) {
@@ -24,10 +35,12 @@ std::vector<Token> lex(const std::vector<std::string>& lines) {
                 // Parse string literal
                 size_t end = line.find('"', j + 1);
                 if (end == std::string::npos) {
-                    throw std::runtime_error("Unterminated string at line " + std::to_string(i + 1));
+                    // Drop the rest of the line and carry on with the next one
+                    diags.error(span_at(j, line.size()), "Unterminated string");
+                    break;
                 }
                 std::string str = line.substr(j + 1, end - j - 1);
-                tokens.push_back({ TokenType::StringLiteral, str, i + 1 });
+                emit(TokenType::StringLiteral, str, j, end + 1);
                 j = end + 1;
             }
             else if (std::isalpha(line[j]) || line[j] == '_') {
@@ -38,27 +51,65 @@ std::vector<Token> lex(const std::vector<std::string>& lines) {
 
                 if (word == "function" || word == "start" || word == "end" ||
                     word == "if" || word == "elif" || word == "else" ||
+                    word == "while" ||
                     word == "say" || word == "set" ||
                     word == "add" || word == "minus" ||
                     word == "multiply" || word == "divide") {
-                    tokens.push_back({ TokenType::Keyword, word, i + 1 });
+                    emit(TokenType::Keyword, word, start, j);
                 }
                 else {
-                    tokens.push_back({ TokenType::Identifier, word, i + 1 });
+                    emit(TokenType::Identifier, word, start, j);
+                }
+            }
+            else if (std::isdigit(line[j]) ||
+                (line[j] == '-' && j + 1 < line.size() && std::isdigit(line[j + 1]))) {
+                // Number literal: optional sign, digits, optional fraction
+                size_t start = j++;
+                while (j < line.size() && std::isdigit(line[j])) ++j;
+                if (j + 1 < line.size() && line[j] == '.' && std::isdigit(line[j + 1])) {
+                    ++j;
+                    while (j < line.size() && std::isdigit(line[j])) ++j;
+                }
+                std::string number = line.substr(start, j - start);
+
+                // Drop leading zeros: C++ would read "010" as octal and reject "09"
+                size_t first = number[0] == '-' ? 1 : 0;
+                size_t nonzero = first;
+                while (nonzero + 1 < number.size() && number[nonzero] == '0' && std::isdigit(number[nonzero + 1])) ++nonzero;
+                number.erase(first, nonzero - first);
+
+                // The bound is symmetric: -9223372036854775808 has no C++ literal spelling
+                if (number.find('.') == std::string::npos) {
+                    const std::string int64_max = "9223372036854775807";
+                    std::string digits = number.substr(first);
+                    if (digits.size() > int64_max.size() ||
+                        (digits.size() == int64_max.size() && digits > int64_max)) {
+                        diags.error(span_at(start, j), "Integer literal " + number + " is out of range (limit is +/-" + int64_max + ")");
+                    }
                 }
+                emit(TokenType::Number, number, start, j);
             }
-            else if (line[j] == ':' || line[j] == '=' || line[j] == '(' || line[j] == ')') {
+            else if ((line[j] == '=' || line[j] == '!' || line[j] == '<' || line[j] == '>') &&
+                j + 1 < line.size() && line[j + 1] == '=') {
+                // Two-character comparison operators
+                emit(TokenType::Symbol, line.substr(j, 2), j, j + 2);
+                j += 2;
+            }
+            else if (line[j] == ':' || line[j] == '=' || line[j] == '(' || line[j] == ')' ||
+                line[j] == ',' || line[j] == '<' || line[j] == '>') {
                 // Symbols
-                tokens.push_back({ TokenType::Symbol, std::string(1, line[j]), i + 1 });
+                emit(TokenType::Symbol, std::string(1, line[j]), j, j + 1);
                 ++j;
             }
             else {
-                // Unexpected character, skip or report
-                ++j;
+                // Unexpected character: report it (a whole UTF-8 sequence at once) and skip
+                size_t start = j++;
+                while (j < line.size() && (static_cast<unsigned char>(line[j]) & 0xC0) == 0x80) ++j;
+                diags.error(span_at(start, j), "Unexpected character '" + line.substr(start, j - start) + "'");
             }
         }
 
-        tokens.push_back({ TokenType::Newline, "\\n", i + 1 });
+        emit(TokenType::Newline, "\\n", line.size(), line.size());
     }
 
     tokens.push_back({ TokenType::EOFToken, "", (int)lines.size() });
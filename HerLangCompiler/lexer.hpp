@@ -9,6 +9,7 @@ enum class TokenType {
     Keyword,
     Identifier,
     StringLiteral,
+    Number,
     Symbol,
     Indent,
     Dedent,
@@ -17,10 +18,23 @@ enum class TokenType {
     Unknown
 };
 
+// Source location: 1-based line and column, length in bytes (col 0 = whole line).
+struct Span {
+    int line = 0;
+    int col = 0;
+    int length = 0;
+};
+
 struct Token {
     TokenType type;
     std::string value;
     int line;
+    int col = 0;
+    int length = 0;
+
+    Span span() const { return Span{ line, col, length }; }
 };
 
-std::vector<Token> lex(const std::vector<std::string>& lines);
+class Diagnostics;
+
+std::vector<Token> lex(const std::vector<std::string>& lines, Diagnostics& diags);
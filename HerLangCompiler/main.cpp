@@ -2,30 +2,88 @@
 #include "lexer.hpp"
 #include "parser.hpp"
 #include "generator.hpp"
+#include "types.hpp"
+#include "diagnostics.hpp"
 #include "warnings.hpp"
 #include "utils.hpp"
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
+
+// Reports the wall-clock time of each compiler phase on stderr (--timings).
+class PhaseTimer {
+public:
+    explicit PhaseTimer(bool enabled) : enabled(enabled), last(std::chrono::steady_clock::now()) {}
+
+    void mark(const char* phase) {
+        if (!enabled) return;
+        auto now = std::chrono::steady_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+        std::cerr << "[Timing] " << phase << " " << us << " us\n";
+        last = now;
+    }
+
+private:
+    bool enabled;
+    std::chrono::steady_clock::time_point last;
+};
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::cerr << "Usage: hcp in.herc out.cpp\n";
+    bool timings = false;
+    size_t max_errors = 20;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--timings") {
+            timings = true;
+        }
+        else if (arg == "--max-errors" && i + 1 < argc) {
+            // Digits only: std::stoull alone accepts "-1" (wrapping) and "10abc"
+            std::string value = argv[++i];
+            bool valid = !value.empty() && value.find_first_not_of("0123456789") == std::string::npos;
+            try {
+                if (valid) max_errors = std::stoull(value);
+            }
+            catch (const std::out_of_range&) {
+                valid = false;
+            }
+            if (!valid) {
+                std::cerr << "Invalid value for --max-errors: " << value << "\n";
+                return 1;
+            }
+        }
+        else {
+            files.push_back(arg);
+        }
+    }
+    if (files.size() != 2) {
+        std::cerr << "Usage: hcp [--timings] [--max-errors N] in.herc out.cpp\n";
         return 1;
     }
+    const std::string& in_path = files[0];
+    const std::string& out_path = files[1];
+
+    PhaseTimer timer(timings);
 
-    std::ifstream input(argv[1]);
+    std::ifstream input(in_path);
     if (!input) {
-        std::cerr << "Cannot open input file: " << argv[1] << "\n";
+        std::cerr << "Cannot open input file: " << in_path << "\n";
         return 1;
     }
 
     std::string source((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
     input.close();
+    timer.mark("read");
 
     check_indentation(source); // Check for indentation warnings
+    timer.mark("indent");
 
+    Diagnostics diags(max_errors);
     auto lines = split_lines(source);
-    auto tokens = lex(lines);
+    auto tokens = lex(lines, diags);
+    timer.mark("lex");
 #if _DEBUG
     std::cerr << "=== Tokens ===\n";
     for (const auto& tok : tokens) {
@@ -34,6 +92,7 @@ int main(int argc, char* argv[]) {
         case TokenType::Keyword:        std::cerr << "Keyword    "; break;
         case TokenType::Identifier:     std::cerr << "Identifier "; break;
         case TokenType::StringLiteral:  std::cerr << "String     "; break;
+        case TokenType::Number:         std::cerr << "Number     "; break;
         case TokenType::Newline:        std::cerr << "Newline    "; break;
         case TokenType::EOFToken:       std::cerr << "EOF        "; break;
         case TokenType::Symbol:         std::cerr << "Symbol     "; break;
@@ -43,7 +102,8 @@ int main(int argc, char* argv[]) {
     std::cerr << "==============\n";
 
 #endif
-    auto ast = parse(tokens);
+    auto ast = parse(tokens, diags);
+    timer.mark("parse");
 #if _DEBUG
     std::cerr << "=== AST ===\n";
     for (const auto& stmt : ast.statements) {
@@ -70,16 +130,27 @@ int main(int argc, char* argv[]) {
     }
     std::cerr << "===========\n";
 #endif
+    // A partial AST would only produce follow-on type errors
+    if (!diags.has_errors()) infer_types(ast, diags);
+    timer.mark("types");
+
+    if (diags.has_errors()) {
+        diags.print(std::cerr, in_path, lines);
+        return 1;
+    }
+
     auto cpp_code = generate_cpp(ast);
+    timer.mark("generate");
 
-    std::ofstream output(argv[2]);
+    std::ofstream output(out_path);
     if (!output) {
-        std::cerr << "Cannot write to output file: " << argv[2] << "\n";
+        std::cerr << "Cannot write to output file: " << out_path << "\n";
         return 1;
     }
     output << cpp_code;
     output.close();
+    timer.mark("write");
 
-    std::cout << "Compilation successful: " << argv[2] << "\n";
+    std::cout << "Compilation successful: " << out_path << "\n";
     return 0;
 }
@@ -1,38 +1,44 @@
 // parser.cpp - MyLang parser implementation
 #include "parser.hpp"
 #include "utils.hpp"
+#include "diagnostics.hpp"
 #include <stdexcept>
 #include <iostream>
 
 static int pos = 0;
-static std::vector<Token> toks;
-
-static Token dummy_eof_token() {
-    return Token{ TokenType::EOFToken, "" };
+static const std::vector<Token>* toks = nullptr; // owned by the caller of parse()
+static Diagnostics* diags = nullptr;
+static std::vector<const Token*> open_blocks; // openers of the blocks being parsed
+static bool stopped = false;
+
+static const Token& dummy_eof_token() {
+    static const Token eof{ TokenType::EOFToken, "" };
+    return eof;
 }
 
-static Token peek() {
-    if (pos >= toks.size()) {
+// Both return references into the token vector, so lookahead does not copy
+static const Token& peek() {
+    if (pos >= toks->size()) {
 #if _DEBUG
-        std::cerr << "[ERROR] peek: pos=" << pos << ", toks.size=" << toks.size() << "\n";
+        std::cerr << "[ERROR] peek: pos=" << pos << ", toks.size=" << toks->size() << "\n";
 #endif
         return dummy_eof_token(); // 쳣 EOF
     }
-    auto t = toks[pos];
+    const Token& t = (*toks)[pos];
 #if _DEBUG
     std::cerr << "[peek] pos=" << pos << ", token=(" << t.value << ")\n";
 #endif
     return t;
 }
 
-static Token advance() {
-    if (pos >= toks.size()) {
+static const Token& advance() {
+    if (pos >= toks->size()) {
 #if _DEBUG
-        std::cerr << "[ERROR] advance: pos=" << pos << ", toks.size=" << toks.size() << "\n";
+        std::cerr << "[ERROR] advance: pos=" << pos << ", toks.size=" << toks->size() << "\n";
 #endif
         return dummy_eof_token(); // 쳣
     }
-    auto t = toks[pos++];
+    const Token& t = (*toks)[pos++];
 #if _DEBUG
     std::cerr << "[advance] pos=" << pos << ", token=(" << t.value << ")\n";
 #endif
@@ -46,104 +52,211 @@ static void skip_newlines() {
     }
 }
 
+// Panic-mode recovery: drop the rest of the current line so parsing resumes
+// at the next statement.
+static void synchronize() {
+    while (peek().type != TokenType::Newline && peek().type != TokenType::EOFToken) {
+        advance();
+    }
+    if (peek().type == TokenType::Newline) advance();
+}
+
+// Records an error at tok (normally the unconsumed lookahead) and recovers.
+static std::shared_ptr<Statement> error_at(const Token& tok, const std::string& message) {
+    diags->error(tok.span(), message);
+    synchronize();
+    return nullptr;
+}
+
+static std::string describe(const Token& t) {
+    switch (t.type) {
+    case TokenType::EOFToken:      return "end of file";
+    case TokenType::Newline:       return "end of line";
+    case TokenType::StringLiteral: return "\"" + t.value + "\"";
+    default:                       return "'" + t.value + "'";
+    }
+}
+
+static bool expect_symbol(const std::string& symbol, const std::string& context) {
+    const Token& t = peek();
+    if (t.type != TokenType::Symbol || t.value != symbol) {
+        error_at(t, "Expected '" + symbol + "' " + context + ", found " + describe(t));
+        return false;
+    }
+    advance();
+    return true;
+}
+
+// Simple statements must end with their line.
+static bool expect_line_end() {
+    const Token& t = peek();
+    if (t.type == TokenType::Newline || t.type == TokenType::EOFToken) return true;
+    error_at(t, "Unexpected " + describe(t) + " after statement");
+    return false;
+}
+
+// True once the diagnostics buffer cannot take any error at or after the
+// current token. Blocks still open could only add a "Missing 'end'" error at
+// their earlier opening line, so the rest of the file is scanned for their
+// 'end's instead of being parsed.
+static bool should_stop() {
+    if (stopped) return true;
+    if (!diags->exhausted_at(peek().line)) return false;
+
+    stopped = true;
+    diags->mark_truncated();
+
+    std::vector<const Token*> unclosed = open_blocks;
+    bool line_start = true;
+    for (size_t i = pos; i < toks->size(); ++i) {
+        const Token& t = (*toks)[i];
+        if (line_start && t.type == TokenType::Keyword) {
+            if (t.value == "function" || t.value == "start" || t.value == "if" || t.value == "while") {
+                unclosed.push_back(&t);
+            }
+            else if (t.value == "end" && !unclosed.empty()) {
+                unclosed.pop_back();
+            }
+        }
+        line_start = t.type == TokenType::Newline;
+    }
+    for (const Token* opener : unclosed) {
+        diags->error(opener->span(), "Missing 'end' for '" + opener->value + "' block");
+    }
+    return true;
+}
+
 std::shared_ptr<Statement> parse_statement();
 
-AST parse(const std::vector<Token>& tokens) {
-    toks = tokens;
+AST parse(const std::vector<Token>& tokens, Diagnostics& diagnostics) {
+    toks = &tokens;
     pos = 0;
+    diags = &diagnostics;
+    open_blocks.clear();
+    stopped = false;
     AST ast;
 
-    while (pos < toks.size()) {
-        Token current = peek();
+    while (pos < toks->size() && !should_stop()) {
+        const Token& current = peek();
         if (current.type == TokenType::EOFToken) break;
 
+        // parse_statement always consumes input, recovering past errors itself
         auto stmt = parse_statement();
         if (stmt) {
             ast.statements.push_back(stmt);
         }
-        else {
-            advance(); // ֹѭ
-        }
     }
 
     return ast;
 }
 
-std::vector<std::shared_ptr<Statement>> parse_block() {
+// Parses statements up to the closing "end" of the block opened by opener.
+// When terminator is given, a leading "elif"/"else" also closes the block; it
+// is left unconsumed and reported through terminator ("end" otherwise).
+std::vector<std::shared_ptr<Statement>> parse_block(const Token& opener, std::string* terminator = nullptr) {
     std::vector<std::shared_ptr<Statement>> body;
-    int safety_counter = 0;
+    open_blocks.push_back(&opener);
 
-    while (true) {
+    while (!should_stop()) {
         skip_newlines();
 
-        Token current = peek();
+        const Token& current = peek();
         if (current.type == TokenType::Keyword && current.value == "end") {
             advance(); // consume "end"
+            if (terminator) *terminator = "end";
+            break;
+        }
+        if (terminator && current.type == TokenType::Keyword &&
+            (current.value == "elif" || current.value == "else")) {
+            *terminator = current.value;
             break;
         }
         if (current.type == TokenType::EOFToken) {
-            throw std::runtime_error("Unexpected end of file inside block.");
+            diags->error(opener.span(), "Missing 'end' for '" + opener.value + "' block");
+            break;
         }
 
         auto stmt = parse_statement();
         if (stmt) {
             body.push_back(stmt);
         }
-        else {
-            advance();
-        }
-
-        // ֹѭ
-        if (++safety_counter > 10000) {
-            throw std::runtime_error("Too many statements parsed without encountering 'end'");
-        }
     }
 
+    open_blocks.pop_back();
     return body;
 }
 
-std::shared_ptr<Statement> parse_statement() {
-    skip_newlines();
+static bool is_operand(const Token& t) {
+    return t.type == TokenType::Identifier || t.type == TokenType::Number ||
+        t.type == TokenType::StringLiteral;
+}
 
-    Token tok = peek();
+static bool parse_operand(const std::string& context, Operand& out) {
+    const Token& t = peek();
+    if (!is_operand(t)) {
+        error_at(t, "Expected a value " + context + ", found " + describe(t));
+        return false;
+    }
+    advance();
+    out = Operand{ t.type, t.value, t.span() };
+    return true;
+}
 
-    if (tok.type == TokenType::EOFToken) {
-        return nullptr;
+// <value> <comparison> <value> ':'
+static bool parse_condition(const std::string& keyword, Condition& cond) {
+    if (!parse_operand("after '" + keyword + "'", cond.lhs)) return false;
+
+    const Token& op = peek();
+    if (op.type != TokenType::Symbol ||
+        (op.value != "==" && op.value != "!=" && op.value != "<" &&
+         op.value != ">" && op.value != "<=" && op.value != ">=")) {
+        error_at(op, "Expected comparison operator in '" + keyword + "', found " + describe(op));
+        return false;
     }
+    advance();
+    cond.op = op.value;
+
+    if (!parse_operand("after '" + op.value + "'", cond.rhs)) return false;
+    return expect_symbol(":", "after " + keyword + " condition");
+}
 
+static std::shared_ptr<Statement> parse_statement_from(const Token& tok) {
     // function definition
     if (tok.type == TokenType::Keyword && tok.value == "function") {
         advance(); // consume 'function'
 
-        Token name = advance();
-        Token maybe_param_or_colon = advance();
-
         std::string param = "";  // ĬΪղ
+        bool ok = false;
 
-        Token colon;
-        if (maybe_param_or_colon.type == TokenType::Symbol && maybe_param_or_colon.value == ":") {
-            // ޲
-            colon = maybe_param_or_colon;
+        const Token& name = peek();
+        if (name.type != TokenType::Identifier) {
+            error_at(name, "Expected function name after 'function', found " + describe(name));
         }
         else {
-            // вӦð
-            param = maybe_param_or_colon.value;
-            colon = advance();
-            if (colon.value != ":") {
-                throw std::runtime_error("Expected ':' after parameter in function definition");
+            advance();
+            if (peek().type == TokenType::Identifier) {
+                // вӦð
+                param = advance().value;
+                ok = expect_symbol(":", "after parameter in function definition");
+            }
+            else {
+                // ޲
+                ok = expect_symbol(":", "after function name");
             }
         }
 
-        auto body = parse_block();
+        // Parse the body even after a bad header so its 'end' stays matched
+        auto body = parse_block(tok);
+        if (!ok) return nullptr;
         return std::make_shared<FunctionDef>(name.value, param, body);
     }
 
     // start block
     if (tok.type == TokenType::Keyword && tok.value == "start") {
         advance();
-        Token colon = advance();
-        if (colon.value != ":") throw std::runtime_error("Expected ':' after start");
-        auto body = parse_block();
+        bool ok = expect_symbol(":", "after 'start'");
+        auto body = parse_block(tok);
+        if (!ok) return nullptr;
         return std::make_shared<StartBlock>(body);
     }
 
@@ -156,7 +269,7 @@ std::shared_ptr<Statement> parse_statement() {
         std::string ending = "\\n"; // default end
 
         while (true) {
-            Token next = peek();
+            const Token& next = peek();
 #if _DEBUG
             std::cerr << "[DEBUG] say loop: next=" << next.value << ", type=" << static_cast<int>(next.type) << "\n";
 #endif
@@ -164,18 +277,15 @@ std::shared_ptr<Statement> parse_statement() {
             if (next.type == TokenType::Keyword && next.value == "end") {
                 advance(); // consume 'end'
 
-                Token eq = peek();
-                if (eq.type != TokenType::Symbol || eq.value != "=") {
-                    throw std::runtime_error("Expected '=' after 'end'");
-                }
-                advance(); // consume '='
+                if (!expect_symbol("=", "after 'end'")) return nullptr;
 
-                Token val = peek();
+                const Token& val = peek();
                 if (val.type != TokenType::StringLiteral) {
-                    throw std::runtime_error("Expected string literal after end=");
+                    return error_at(val, "Expected string literal after end=, found " + describe(val));
                 }
                 ending = advance().value;
 
+                if (!expect_line_end()) return nullptr;
                 break; //  say 
             }
 
@@ -185,19 +295,20 @@ std::shared_ptr<Statement> parse_statement() {
             }
 
             // 
-            if (next.type == TokenType::StringLiteral || next.type == TokenType::Identifier) {
-                Token arg = advance();
+            if (next.type == TokenType::StringLiteral || next.type == TokenType::Identifier ||
+                next.type == TokenType::Number) {
+                const Token& arg = advance();
                 args.push_back(arg.value);
-                is_vars.push_back(arg.type == TokenType::Identifier);
+                is_vars.push_back(arg.type != TokenType::StringLiteral);
 
                 // ѡ
-                Token comma = peek();
+                const Token& comma = peek();
                 if (comma.type == TokenType::Symbol && comma.value == ",") {
                     advance(); // consume comma
                 }
             }
             else {
-                throw std::runtime_error("Unexpected token in 'say': " + next.value);
+                return error_at(next, "Unexpected " + describe(next) + " in 'say'");
             }
         }
 
@@ -211,37 +322,130 @@ std::shared_ptr<Statement> parse_statement() {
     // set
     if (tok.type == TokenType::Keyword && tok.value == "set") {
         advance();
-        Token var = advance();
-        return std::make_shared<SetStatement>(var.value);
+        const Token& var = peek();
+        if (var.type != TokenType::Identifier) {
+            return error_at(var, "Expected variable name after 'set', found " + describe(var));
+        }
+        advance();
+
+        Operand value;
+        const Token& eq = peek();
+        if (eq.type == TokenType::Symbol && eq.value == "=") {
+            advance(); // consume '='
+            if (!parse_operand("after '='", value)) return nullptr;
+        }
+        if (!expect_line_end()) return nullptr;
+        return std::make_shared<SetStatement>(var.value, value);
+    }
+
+    // add / minus / multiply / divide
+    if (tok.type == TokenType::Keyword &&
+        (tok.value == "add" || tok.value == "minus" || tok.value == "multiply" || tok.value == "divide")) {
+        advance();
+        const Token& var = peek();
+        if (var.type != TokenType::Identifier) {
+            return error_at(var, "Expected variable name after '" + tok.value + "', found " + describe(var));
+        }
+        advance();
+
+        Operand value;
+        if (!parse_operand("after '" + tok.value + " " + var.value + "'", value)) return nullptr;
+        if (!expect_line_end()) return nullptr;
+        return std::make_shared<ArithStatement>(tok.value, var.value, value);
+    }
+
+    // if / elif / else, closed by a single "end"
+    if (tok.type == TokenType::Keyword && tok.value == "if") {
+        advance(); // consume 'if'
+        auto stmt = std::make_shared<IfStatement>();
+        bool ok = true;
+
+        std::string term;
+        Condition cond;
+        ok = parse_condition("if", cond) && ok;
+        stmt->conds.push_back(cond);
+        stmt->bodies.push_back(parse_block(tok, &term));
+
+        while (term == "elif") {
+            const Token& elif = advance(); // consume 'elif'
+            Condition elif_cond;
+            ok = parse_condition("elif", elif_cond) && ok;
+            stmt->conds.push_back(elif_cond);
+            stmt->bodies.push_back(parse_block(elif, &term));
+        }
+
+        if (term == "else") {
+            const Token& else_tok = advance(); // consume 'else'
+            ok = expect_symbol(":", "after 'else'") && ok;
+            stmt->else_body = parse_block(else_tok);
+        }
+
+        if (!ok) return nullptr;
+        return stmt;
+    }
+
+    if (tok.type == TokenType::Keyword && (tok.value == "elif" || tok.value == "else")) {
+        return error_at(tok, "'" + tok.value + "' without matching 'if'");
+    }
+
+    if (tok.type == TokenType::Keyword && tok.value == "end") {
+        return error_at(tok, "'end' without matching block start");
+    }
+
+    // while
+    if (tok.type == TokenType::Keyword && tok.value == "while") {
+        advance(); // consume 'while'
+        Condition cond;
+        bool ok = parse_condition("while", cond);
+        auto body = parse_block(tok);
+        if (!ok) return nullptr;
+        return std::make_shared<WhileStatement>(cond, body);
     }
 
     // function call
     if (tok.type == TokenType::Identifier) {
-        Token func = advance();
-        Token next = peek();
-        if (next.type == TokenType::StringLiteral || next.type == TokenType::Identifier) {
-            Token arg = advance();
+        const Token& func = advance();
+        const Token& next = peek();
+        std::shared_ptr<Statement> call;
+        if (next.type == TokenType::StringLiteral || next.type == TokenType::Identifier ||
+            next.type == TokenType::Number) {
+            const Token& arg = advance();
 #if _DEBUG
             std::cerr << "[DEBUG] function call arg " << arg.value << " ";
             switch (arg.type) {
             case TokenType::Keyword:        std::cerr << "Keyword    "; break;
             case TokenType::Identifier:     std::cerr << "Identifier "; break;
             case TokenType::StringLiteral:  std::cerr << "String     "; break;
+            case TokenType::Number:         std::cerr << "Number     "; break;
             case TokenType::Newline:        std::cerr << "Newline    "; break;
             case TokenType::EOFToken:       std::cerr << "EOF        "; break;
             case TokenType::Symbol:         std::cerr << "Symbol     "; break;
             }
             std::cerr << std::endl;
 #endif
-            return std::make_shared<FunctionCall>(func.value, arg.value, arg.type);
+            call = std::make_shared<FunctionCall>(func.value, arg.value, arg.type);
         }
         else {
-            return std::make_shared<FunctionCall>(func.value, "", TokenType::EOFToken);
+            call = std::make_shared<FunctionCall>(func.value, "", TokenType::EOFToken);
         }
+        if (!expect_line_end()) return nullptr;
+        return call;
     }
 
+    // δ֪䣬
+    return error_at(tok, "Unexpected " + describe(tok) + " at start of statement");
+}
 
-    // δ֪䣬ѭ
-    advance();
-    return nullptr;
+std::shared_ptr<Statement> parse_statement() {
+    skip_newlines();
+
+    const Token& tok = peek();
+
+    if (tok.type == TokenType::EOFToken) {
+        return nullptr;
+    }
+
+    auto stmt = parse_statement_from(tok);
+    if (stmt) stmt->span = tok.span();
+    return stmt;
 }
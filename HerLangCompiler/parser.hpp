@@ -4,4 +4,6 @@
 #include "lexer.hpp"
 #include <vector>
 
-AST parse(const std::vector<Token>& tokens);
+class Diagnostics;
+
+AST parse(const std::vector<Token>& tokens, Diagnostics& diags);
@@ -0,0 +1,299 @@
+// types.cpp - Static type inference pass
+#include "types.hpp"
+#include "diagnostics.hpp"
+#include <cctype>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+using Body = std::vector<std::shared_ptr<Statement>>;
+
+struct Scope {
+    std::string param; // empty for start blocks
+    std::unordered_map<std::string, ValueType> vars;
+    std::vector<std::string> order; // declaration order, param excluded
+};
+
+const char* type_name(ValueType t) {
+    switch (t) {
+    case ValueType::Int:    return "int";
+    case ValueType::Double: return "double";
+    case ValueType::String: return "string";
+    default:                return "unknown";
+    }
+}
+
+bool is_numeric(ValueType t) {
+    return t == ValueType::Int || t == ValueType::Double;
+}
+
+bool compatible(ValueType a, ValueType b) {
+    return a == ValueType::Unknown || b == ValueType::Unknown || a == b || (is_numeric(a) && is_numeric(b));
+}
+
+// Least upper bound of two compatible types: Unknown < Int < Double.
+// Variables are typed per scope, not per statement, so widening a variable
+// to Double also affects its uses before the widening assignment.
+ValueType join(ValueType a, ValueType b) {
+    if (a == ValueType::Unknown) return b;
+    if (b == ValueType::Unknown || a == b) return a;
+    return ValueType::Double;
+}
+
+ValueType literal_type(const std::string& text) {
+    return text.find('.') == std::string::npos ? ValueType::Int : ValueType::Double;
+}
+
+// Names are emitted verbatim into the generated C++, so they must not be
+// keywords there; "main" is taken by the start block.
+bool is_cpp_keyword(const std::string& name) {
+    static const std::unordered_set<std::string> keywords = {
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+        "case", "catch", "char", "char16_t", "char32_t", "char8_t", "class", "co_await", "co_return",
+        "co_yield", "compl", "concept", "const", "const_cast", "consteval", "constexpr", "constinit",
+        "continue", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+        "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+        "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr",
+        "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast",
+        "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast",
+        "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef",
+        "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t",
+        "while", "xor", "xor_eq",
+    };
+    return keywords.count(name) > 0;
+}
+
+class Inferencer {
+public:
+    Inferencer(AST& ast, Diagnostics& diags) : diags(diags) {
+        for (auto& stmt : ast.statements) {
+            auto func = dynamic_cast<FunctionDef*>(stmt.get());
+            if (!func) continue;
+            if (func->name == "main" || is_cpp_keyword(func->name)) {
+                diags.error(func->span, "'" + func->name + "' is a reserved name and cannot be used for a function");
+            }
+            if (is_cpp_keyword(func->param)) {
+                diags.error(func->span, "'" + func->param + "' is a reserved name and cannot be used for a parameter");
+            }
+            auto [it, inserted] = functions.emplace(func->name, func);
+            if (!inserted) {
+                diags.error(func->span, "Function '" + func->name + "' is already defined at line " +
+                    std::to_string(it->second->span.line));
+            }
+        }
+    }
+
+    void run(AST& ast) {
+        // Collect declarations first so that use-before-set in source order
+        // (e.g. inside a loop) is still accepted.
+        std::vector<std::pair<Statement*, Scope>> scopes;
+        for (auto& stmt : ast.statements) {
+            if (auto func = dynamic_cast<FunctionDef*>(stmt.get())) {
+                Scope scope;
+                scope.param = func->param;
+                if (!func->param.empty()) scope.vars[func->param] = ValueType::Unknown;
+                declare(scope, func->body);
+                scopes.emplace_back(func, std::move(scope));
+            }
+            else if (auto start = dynamic_cast<StartBlock*>(stmt.get())) {
+                Scope scope;
+                declare(scope, start->body);
+                scopes.emplace_back(start, std::move(scope));
+            }
+        }
+
+        // Types only ever move up the lattice, so this terminates quickly.
+        // Conflicts are skipped here and reported once the types are stable.
+        do {
+            changed = false;
+            visit_all(scopes);
+        } while (changed);
+
+        // Clean inputs never hit a conflict, so they skip the extra pass
+        if (skipped) {
+            reporting = true;
+            visit_all(scopes);
+        }
+
+        for (auto& [owner, scope] : scopes) {
+            std::vector<std::pair<std::string, ValueType>> locals;
+            for (auto& name : scope.order) {
+                ValueType t = scope.vars[name];
+                // Only reachable through parameters of never-called functions.
+                locals.emplace_back(name, t == ValueType::Unknown ? ValueType::Int : t);
+            }
+            if (auto func = dynamic_cast<FunctionDef*>(owner)) {
+                func->locals = std::move(locals);
+                // Parameters of never-called functions are otherwise unconstrained.
+                if (!func->param.empty() && func->param_type == ValueType::Unknown) func->param_type = ValueType::Int;
+            }
+            else {
+                static_cast<StartBlock*>(owner)->locals = std::move(locals);
+            }
+        }
+    }
+
+private:
+    Diagnostics& diags;
+    std::unordered_map<std::string, FunctionDef*> functions;
+    bool changed = false;
+    bool reporting = false;
+    bool skipped = false; // an error was seen before reporting was enabled
+
+    void report(const Span& span, const std::string& message) {
+        if (reporting) diags.error(span, message);
+        else skipped = true;
+    }
+
+    void visit_all(std::vector<std::pair<Statement*, Scope>>& scopes) {
+        for (auto& [owner, scope] : scopes) {
+            if (auto func = dynamic_cast<FunctionDef*>(owner)) {
+                if (!scope.param.empty()) update(scope, scope.param, func->param_type, func->span, "parameter");
+                visit(scope, func->body);
+                func->param_type = scope.param.empty() ? ValueType::Unknown : scope.vars[scope.param];
+            }
+            else {
+                visit(scope, static_cast<StartBlock*>(owner)->body);
+            }
+        }
+    }
+
+    void declare(Scope& scope, const Body& body) {
+        for (auto& stmt : body) {
+            if (auto set = dynamic_cast<SetStatement*>(stmt.get())) {
+                if (!scope.vars.count(set->var)) {
+                    if (is_cpp_keyword(set->var)) {
+                        diags.error(set->span, "'" + set->var + "' is a reserved name and cannot be used for a variable");
+                    }
+                    scope.vars[set->var] = ValueType::Unknown;
+                    scope.order.push_back(set->var);
+                }
+            }
+            else if (auto branch = dynamic_cast<IfStatement*>(stmt.get())) {
+                for (auto& b : branch->bodies) declare(scope, b);
+                declare(scope, branch->else_body);
+            }
+            else if (auto loop = dynamic_cast<WhileStatement*>(stmt.get())) {
+                declare(scope, loop->body);
+            }
+        }
+    }
+
+    ValueType type_of(Scope& scope, const Operand& op) {
+        switch (op.kind) {
+        case TokenType::Number:        return literal_type(op.text);
+        case TokenType::StringLiteral: return ValueType::String;
+        case TokenType::EOFToken:      return ValueType::Int; // bare "set x"
+        default: {
+            auto it = scope.vars.find(op.text);
+            if (it == scope.vars.end()) {
+                report(op.span, "Undefined variable '" + op.text + "'");
+                return ValueType::Unknown;
+            }
+            return it->second;
+        }
+        }
+    }
+
+    // Joins t into the type of var; span locates the assignment for errors.
+    // kind ("variable"/"parameter") only names var in the error message, which
+    // is built on conflict so clean inputs do not pay for it.
+    void update(Scope& scope, const std::string& var, ValueType t, const Span& span, const char* kind) {
+        ValueType& slot = scope.vars[var];
+        if (!compatible(slot, t)) {
+            report(span, std::string("Type mismatch for ") + kind + " '" + var + "': " + type_name(slot) + " vs " + type_name(t));
+            return;
+        }
+        ValueType joined = join(slot, t);
+        if (joined != slot) {
+            slot = joined;
+            changed = true;
+        }
+    }
+
+    void check_condition(Scope& scope, const Condition& cond) {
+        ValueType l = type_of(scope, cond.lhs);
+        ValueType r = type_of(scope, cond.rhs);
+        if (!compatible(l, r)) {
+            report(cond.lhs.span, "Cannot compare " + std::string(type_name(l)) + " with " + type_name(r) +
+                " ('" + cond.lhs.text + " " + cond.op + " " + cond.rhs.text + "')");
+        }
+    }
+
+    void visit(Scope& scope, const Body& body) {
+        for (auto& stmt : body) {
+            if (auto set = dynamic_cast<SetStatement*>(stmt.get())) {
+                update(scope, set->var, type_of(scope, set->value), set->span, "variable");
+            }
+            else if (auto arith = dynamic_cast<ArithStatement*>(stmt.get())) {
+                if (!scope.vars.count(arith->var)) {
+                    report(arith->span, "Undefined variable '" + arith->var + "' in '" + arith->op + "'");
+                    continue;
+                }
+                ValueType t = type_of(scope, arith->value);
+                if ((t == ValueType::String || scope.vars[arith->var] == ValueType::String) && arith->op != "add") {
+                    report(arith->span, "'" + arith->op + "' is not defined for strings (variable '" + arith->var + "')");
+                    continue;
+                }
+                update(scope, arith->var, t, arith->span, "variable");
+            }
+            else if (auto say = dynamic_cast<SayStatement*>(stmt.get())) {
+                for (size_t i = 0; i < say->args.size(); ++i) {
+                    if (say->is_vars[i] && !std::isdigit(static_cast<unsigned char>(say->args[i][0])) &&
+                        say->args[i][0] != '-' && !scope.vars.count(say->args[i])) {
+                        report(say->span, "Undefined variable '" + say->args[i] + "' in 'say'");
+                    }
+                }
+            }
+            else if (auto call = dynamic_cast<FunctionCall*>(stmt.get())) {
+                auto it = functions.find(call->name);
+                if (it == functions.end()) {
+                    report(call->span, "Call to undefined function '" + call->name + "'");
+                    continue;
+                }
+                FunctionDef* callee = it->second;
+                bool has_arg = call->arg_type != TokenType::EOFToken; // "" is still an argument
+                if (has_arg && callee->param.empty()) {
+                    report(call->span, "Function '" + callee->name + "' takes no argument");
+                    continue;
+                }
+                if (!has_arg && !callee->param.empty()) {
+                    report(call->span, "Function '" + callee->name + "' expects an argument for '" + callee->param + "'");
+                    continue;
+                }
+                if (has_arg) {
+                    Operand arg{ call->arg_type, call->arg, call->span };
+                    ValueType t = type_of(scope, arg);
+                    if (!compatible(callee->param_type, t)) {
+                        report(call->span, "Type mismatch for parameter '" + callee->param + "' of '" + callee->name + "': " +
+                            type_name(callee->param_type) + " vs " + type_name(t));
+                        continue;
+                    }
+                    ValueType joined = join(callee->param_type, t);
+                    if (joined != callee->param_type) {
+                        callee->param_type = joined;
+                        changed = true;
+                    }
+                }
+            }
+            else if (auto branch = dynamic_cast<IfStatement*>(stmt.get())) {
+                for (size_t i = 0; i < branch->conds.size(); ++i) {
+                    check_condition(scope, branch->conds[i]);
+                    visit(scope, branch->bodies[i]);
+                }
+                visit(scope, branch->else_body);
+            }
+            else if (auto loop = dynamic_cast<WhileStatement*>(stmt.get())) {
+                check_condition(scope, loop->cond);
+                visit(scope, loop->body);
+            }
+        }
+    }
+};
+
+} // namespace
+
+void infer_types(AST& ast, Diagnostics& diags) {
+    Inferencer(ast, diags).run(ast);
+}
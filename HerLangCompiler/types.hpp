@@ -0,0 +1,10 @@
+// types.hpp - Static type inference pass
+#pragma once
+#include "ast.hpp"
+
+class Diagnostics;
+
+// Assigns a ValueType to every variable and function parameter so the
+// generator can emit concrete native types instead of `auto`. Type errors
+// are recorded in diags.
+void infer_types(AST& ast, Diagnostics& diags);
@@ -38,8 +38,20 @@ void check_indentation(const std::string& source) {
                 indent_stack.pop();
             }
         }
+        else if (trimmed.find("elif") == 0 || trimmed.find("else") == 0) {
+            // elif/else continue the enclosing if block, which shares one 'end'
+            if (indent_stack.empty()) {
+                std::cerr << "[Warning] Line " << lineno << ": '" << trimmed.substr(0, 4)
+                    << "' without matching 'if'.\n";
+            }
+            else if (indent != indent_stack.top()) {
+                std::cerr << "[Warning] Line " << lineno << ": '" << trimmed.substr(0, 4)
+                    << "' indentation mismatch. Expected " << indent_stack.top()
+                    << " spaces but got " << indent << ".\n";
+            }
+        }
         else if (trimmed.find("function") == 0 || trimmed.find("start:") == 0 ||
-            trimmed.find("if") == 0 || trimmed.find("elif") == 0 || trimmed.find("else") == 0) {
+            trimmed.find("if") == 0 || trimmed.find("while") == 0) {
             // ´ʼѹ뵱ǰ
             indent_stack.push(indent);
         }
@@ -0,0 +1,24 @@
+// collatz.cpp - hand-written equivalent of collatz.herc
+#include <cstdint>
+#include <iostream>
+
+static void collatz(int64_t limit) {
+    int64_t best = 0, best_n = 0;
+    for (int64_t n = 1; n < limit; ++n) {
+        int64_t x = n, steps = 0;
+        while (x != 1) {
+            x = (x % 2 == 0) ? x / 2 : 3 * x + 1;
+            ++steps;
+        }
+        if (steps > best) {
+            best = steps;
+            best_n = n;
+        }
+    }
+    std::cout << best_n << " " << best << '\n';
+}
+
+int main() {
+    collatz(1000000);
+    return 0;
+}
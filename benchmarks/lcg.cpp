@@ -0,0 +1,13 @@
+// lcg.cpp - hand-written equivalent of lcg.herc
+#include <cstdint>
+#include <iostream>
+
+int main() {
+    int64_t x = 1, total = 0;
+    for (int64_t i = 0; i < 100000000; ++i) {
+        x = x * 48271 % 2147483647;
+        total += x;
+    }
+    std::cout << total << '\n';
+    return 0;
+}
@@ -0,0 +1,13 @@
+// leibniz.cpp - hand-written equivalent of leibniz.herc
+#include <cstdint>
+#include <iostream>
+
+int main() {
+    double sum = 0.0, sign = 1.0;
+    for (int64_t k = 0; k < 200000000; ++k) {
+        sum += sign / static_cast<double>(2 * k + 1);
+        sign = -sign;
+    }
+    std::cout << sum * 4 << '\n';
+    return 0;
+}
@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+# run.sh - time HerLang-generated programs against hand-written C++
+#
+# Usage: benchmarks/run.sh [path/to/hcp]
+# Environment: CXX (default g++), CXXFLAGS (default "-O2 -std=c++17")
+set -euo pipefail
+
+here="$(cd "$(dirname "$0")" && pwd)"
+hcp="$(realpath "${1:-$here/../build/hcp}")"
+cxx="${CXX:-g++}"
+cxxflags="${CXXFLAGS:--O2 -std=c++17}"
+work="$(mktemp -d)"
+trap 'rm -rf "$work"' EXIT
+
+elapsed_ms() {
+    local start end
+    start=$(date +%s%N)
+    "$@" > /dev/null
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+printf "%-12s %10s %10s %8s\n" "benchmark" "herc (ms)" "c++ (ms)" "ratio"
+for herc in "$here"/*.herc; do
+    name="$(basename "$herc" .herc)"
+    "$hcp" "$herc" "$work/$name.gen.cpp" > /dev/null
+    $cxx $cxxflags "$work/$name.gen.cpp" -o "$work/$name.herc.bin"
+    $cxx $cxxflags "$here/$name.cpp" -o "$work/$name.cpp.bin"
+
+    if [ "$("$work/$name.herc.bin")" != "$("$work/$name.cpp.bin")" ]; then
+        echo "$name: output differs from hand-written C++" >&2
+        exit 1
+    fi
+
+    t_herc=$(elapsed_ms "$work/$name.herc.bin")
+    t_cpp=$(elapsed_ms "$work/$name.cpp.bin")
+    ratio=$(awk -v a="$t_herc" -v b="$t_cpp" 'BEGIN { printf "%.2f", (b > 0 ? a / b : 1) }')
+    printf "%-12s %10d %10d %8s\n" "$name" "$t_herc" "$t_cpp" "$ratio"
+done
@@ -0,0 +1,270 @@
+#!/usr/bin/env bash
+# run_tests.sh - differential and performance regression harness
+#
+# Usage: run_tests.sh golden|perf path/to/hcp [c++ compiler]
+#
+#   golden  compile every corpus/*.herc, build the generated C++ and compare
+#           the program's stdout with the matching corpus/*.out file; compile
+#           every errors/*.herc and compare the diagnostics with errors/*.err
+#           (extra hcp options come from a "# hcp-args: ..." line in the file)
+#   perf    measure compiler phase times (hcp --timings) and generated-program
+#           run times, and compare them with a stored baseline
+#
+# Environment:
+#   HERC_RUN_TIMEOUT      seconds a generated program may run before it is
+#                         counted as a failure (default: 60)
+#
+# Environment (perf only):
+#   HERC_PERF_BASELINE    baseline file (default: ./perf_baseline.txt);
+#                         recorded from the current run when missing
+#   HERC_PERF_THRESHOLD   allowed slowdown in percent (default: 25)
+#   HERC_PERF_MIN_US      slowdowns below this many microseconds are treated
+#                         as noise (default: 10000)
+#   HERC_PERF_RUNS        runs per measurement, the fastest is kept (default: 5)
+#   HERC_UPDATE_BASELINE  set to 1 to overwrite the baseline with this run
+set -euo pipefail
+
+mode="${1:-}"
+hcp="${2:-}"
+cxx="${3:-g++}"
+if [[ "$mode" != "golden" && "$mode" != "perf" ]] || [[ -z "$hcp" ]]; then
+    echo "Usage: $0 golden|perf path/to/hcp [c++ compiler]" >&2
+    exit 2
+fi
+
+[[ "$hcp" == */* ]] && hcp="$(realpath "$hcp")"
+
+here="$(cd "$(dirname "$0")" && pwd)"
+corpus="$here/corpus"
+errors="$here/errors"
+cxxflags=(-O2 -std=c++17)
+run_timeout="${HERC_RUN_TIMEOUT:-60}"
+work="$(mktemp -d)"
+trap 'rm -rf "$work"' EXIT
+
+# compile <name> <input.herc>: .herc -> $work/<name>.cpp -> $work/<name>.bin
+compile() {
+    if ! "$hcp" "$2" "$work/$1.cpp" > /dev/null 2> "$work/$1.hcp.log"; then
+        echo "FAIL $1: hcp failed" >&2
+        cat "$work/$1.hcp.log" >&2
+        return 1
+    fi
+    if ! "$cxx" "${cxxflags[@]}" "$work/$1.cpp" -o "$work/$1.bin" 2> "$work/$1.cxx.log"; then
+        echo "FAIL $1: generated C++ does not build" >&2
+        cat "$work/$1.cxx.log" >&2
+        return 1
+    fi
+}
+
+# run_program <name> <stdout file>: run $work/<name>.bin under the time limit;
+# a crash, a non-zero exit or a timeout is reported as a failure
+run_program() {
+    local status=0
+    timeout "$run_timeout" "$work/$1.bin" > "$2" || status=$?
+    if [[ $status -eq 124 ]]; then
+        echo "FAIL $1: did not finish within ${run_timeout}s" >&2
+        return 1
+    elif [[ $status -ne 0 ]]; then
+        echo "FAIL $1: program exited with status $status" >&2
+        return 1
+    fi
+}
+
+run_golden() {
+    local failed=0 total=0
+    for herc in "$corpus"/*.herc; do
+        local name
+        name="$(basename "$herc" .herc)"
+        total=$((total + 1))
+        compile "$name" "$herc" || { failed=$((failed + 1)); continue; }
+
+        run_program "$name" "$work/$name.actual" || { failed=$((failed + 1)); continue; }
+        if ! diff -u "$corpus/$name.out" "$work/$name.actual" > "$work/$name.diff"; then
+            echo "FAIL $name: output differs from $name.out" >&2
+            cat "$work/$name.diff" >&2
+            failed=$((failed + 1))
+            continue
+        fi
+        echo "ok   $name"
+    done
+
+    for herc in "$errors"/*.herc; do
+        local name
+        name="errors/$(basename "$herc" .herc)"
+        total=$((total + 1))
+
+        local args
+        read -ra args <<< "$(sed -n 's/^# hcp-args: //p' "$herc")"
+
+        # Diagnostics name the input file, so compile from its directory
+        if (cd "$errors" && "$hcp" "${args[@]}" "$(basename "$herc")" "$work/error.cpp") > /dev/null 2> "$work/error.log"; then
+            echo "FAIL $name: expected compile errors" >&2
+            failed=$((failed + 1))
+            continue
+        fi
+        grep -v '^\[Warning\]' "$work/error.log" > "$work/error.actual" || true
+        if ! diff -u "${herc%.herc}.err" "$work/error.actual" > "$work/error.diff"; then
+            echo "FAIL $name: diagnostics differ from $(basename "$herc" .herc).err" >&2
+            cat "$work/error.diff" >&2
+            failed=$((failed + 1))
+            continue
+        fi
+        echo "ok   $name"
+    done
+    # Blocks have no statement limit: generated files can be arbitrarily long
+    total=$((total + 1))
+    { echo "start:"; seq 1 10001 | sed 's/^/    say /'; echo "end"; } > "$work/long_block.herc"
+    if compile long_block "$work/long_block.herc" &&
+        run_program long_block "$work/long_block.actual" &&
+        [[ "$(wc -l < "$work/long_block.actual")" -eq 10001 ]]; then
+        echo "ok   long_block (generated, 10001 statements)"
+    else
+        echo "FAIL long_block: a 10001-statement block did not compile and run" >&2
+        failed=$((failed + 1))
+    fi
+
+    # corpus/readme_example.herc must stay identical to the README example
+    total=$((total + 1))
+    awk '/^## Variables, arithmetic and control flow/ { section = 1 }
+        section && /^```herlang$/ { inside = 1; next }
+        inside && /^```$/ { exit }
+        inside' "$here/../README.md" > "$work/readme.herc"
+    if ! tail -n +2 "$corpus/readme_example.herc" | diff -u - "$work/readme.herc" > "$work/readme.diff"; then
+        echo "FAIL readme_example: corpus/readme_example.herc differs from the README example" >&2
+        cat "$work/readme.diff" >&2
+        failed=$((failed + 1))
+    else
+        echo "ok   readme_example (matches README.md)"
+    fi
+
+    echo "$((total - failed))/$total corpus programs passed"
+    [[ $failed -eq 0 ]]
+}
+
+# A synthetic program large enough for compiler phase times to be measurable.
+write_large_program() {
+    local funcs=2000 i
+    {
+        for ((i = 0; i < funcs; i++)); do
+            echo "function f$i n:"
+            echo "    set acc = $i"
+            echo "    while acc < 100:"
+            echo "        add acc n"
+            echo "        if acc == 50:"
+            echo "            say \"half\" acc"
+            echo "        elif acc > 90:"
+            echo "            multiply acc 2"
+            echo "        else:"
+            echo "            minus acc 1"
+            echo "        end"
+            echo "    end"
+            echo "    say \"f$i\" acc"
+            echo "end"
+            echo
+        done
+        echo "start:"
+        for ((i = 0; i < funcs; i++)); do
+            echo "    f$i $((i % 7 + 1))"
+        done
+        echo "end"
+    } > "$1"
+}
+
+now_us() {
+    echo $(( $(date +%s%N) / 1000 ))
+}
+
+# measure <name> <input.herc> <run?>: append "<metric> <us>" lines to $work/current;
+# returns non-zero when the program does not compile or does not run cleanly
+measure() {
+    local name="$1" herc="$2" run="$3" i
+    if [[ "$run" == "run" ]]; then
+        compile "$name" "$herc" || return 1
+    elif ! "$hcp" "$herc" "$work/$name.cpp" > /dev/null 2> "$work/$name.hcp.log"; then
+        echo "FAIL $name: hcp failed" >&2
+        cat "$work/$name.hcp.log" >&2
+        return 1
+    fi
+
+    for ((i = 0; i < runs; i++)); do
+        "$hcp" --timings "$herc" "$work/$name.cpp" 2>&1 > /dev/null | grep '^\[Timing\]'
+    done | awk -v name="$name" '
+        { if (!($2 in best) || $3 < best[$2]) best[$2] = $3 }
+        END { for (p in best) printf "compile.%s.%s %d\n", name, p, best[p] }' >> "$work/current"
+
+    [[ "$run" == "run" ]] || return 0
+    local best=-1 start elapsed
+    for ((i = 0; i < runs; i++)); do
+        start=$(now_us)
+        run_program "$name" /dev/null || return 1
+        elapsed=$(( $(now_us) - start ))
+        if [[ $best -lt 0 || $elapsed -lt $best ]]; then best=$elapsed; fi
+    done
+    echo "run.$name $best" >> "$work/current"
+}
+
+run_perf() {
+    local baseline="${HERC_PERF_BASELINE:-$PWD/perf_baseline.txt}"
+    local threshold="${HERC_PERF_THRESHOLD:-25}"
+    local min_us="${HERC_PERF_MIN_US:-10000}"
+    runs="${HERC_PERF_RUNS:-5}"
+
+    local broken=0
+    : > "$work/current"
+    for herc in "$corpus"/*.herc; do
+        measure "$(basename "$herc" .herc)" "$herc" run || broken=$((broken + 1))
+    done
+    write_large_program "$work/large.herc"
+    measure large "$work/large.herc" norun || broken=$((broken + 1))
+    sort -o "$work/current" "$work/current"
+
+    # Timings of programs that failed mean nothing; never record them
+    if [[ $broken -gt 0 ]]; then
+        echo "$broken program(s) failed to compile or run, nothing compared" >&2
+        return 1
+    fi
+
+    if [[ ! -f "$baseline" || "${HERC_UPDATE_BASELINE:-0}" == "1" ]]; then
+        cp "$work/current" "$baseline"
+        echo "Recorded performance baseline: $baseline"
+        cat "$baseline"
+        return 0
+    fi
+
+    awk -v threshold="$threshold" -v min_us="$min_us" '
+        NR == FNR { base[$1] = $2; next }
+        {
+            seen[$1] = 1
+            status = "ok  "
+            if ($1 in base) {
+                limit = base[$1] * (1 + threshold / 100)
+                if ($2 > limit && $2 - base[$1] > min_us) { status = "SLOW"; failed++ }
+                printf "%s %-36s %10d us (baseline %d us)\n", status, $1, $2, base[$1]
+            }
+            else {
+                printf "new  %-36s %10d us\n", $1, $2
+            }
+        }
+        END {
+            # A phase or program that stopped reporting must not pass silently
+            for (key in base) {
+                if (!(key in seen)) {
+                    printf "MISS %-36s not measured in this run\n", key
+                    missing++
+                }
+            }
+            if (failed) {
+                printf "%d metric(s) regressed by more than %s%% against the baseline\n", failed, threshold
+            }
+            if (missing) {
+                printf "%d baseline metric(s) missing from this run\n", missing
+            }
+            if (failed || missing) exit 1
+        }' "$baseline" "$work/current"
+}
+
+if [[ "$mode" == "golden" ]]; then
+    run_golden
+else
+    run_perf
+fi